@@ -0,0 +1,293 @@
+/*---------------------------------------------------------------------------*\
+  =========                 |
+  \\      /  F ield         | OpenFOAM: The Open Source CFD Toolbox
+   \\    /   O peration     |
+    \\  /    A nd           | Copyright held by original author
+     \\/     M anipulation  |
+-------------------------------------------------------------------------------
+License
+    This file is part of OpenFOAM.
+
+    OpenFOAM is free software; you can redistribute it and/or modify it
+    under the terms of the GNU General Public License as published by the
+    Free Software Foundation; either version 2 of the License, or (at your
+    option) any later version.
+
+    OpenFOAM is distributed in the hope that it will be useful, but WITHOUT
+    ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+    FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+    for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with OpenFOAM; if not, write to the Free Software Foundation,
+    Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA
+
+Description
+    CUDA backend for batched Moment-of-Fluid reconstruction
+
+Author
+    Sandeep Menon
+    University of Massachusetts Amherst
+    All rights reserved
+
+\*---------------------------------------------------------------------------*/
+
+#include "MoFDevice.H"
+
+#include <cuda_runtime.h>
+
+// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * //
+
+namespace Foam
+{
+
+namespace MoFDevice
+{
+
+// Threads per block of the reconstruction kernel
+static const int blockSize = 128;
+
+// Reconstruct one cell per thread
+__global__ void reconstructKernel
+(
+    const int nCells,
+    const int* offsets,
+    const double* tets,
+    const double* fractions,
+    const double* refCentres,
+    const double* seeds,
+    const MoFKernel::settings s,
+    double* normals,
+    double* distances,
+    double* centres,
+    int* nIters,
+    int* nFnEvals,
+    int* nEvals,
+    int* converged
+)
+{
+    const int cellI = (blockIdx.x * blockDim.x) + threadIdx.x;
+
+    if (cellI >= nCells)
+    {
+        return;
+    }
+
+    const int start = offsets[cellI];
+
+    MoFKernel::reconstructCell
+    (
+        tets + (12 * start),
+        offsets[cellI + 1] - start,
+        fractions[cellI],
+        refCentres + (3 * cellI),
+        seeds + (3 * cellI),
+        s,
+        normals + (3 * cellI),
+        distances[cellI],
+        centres + (3 * cellI),
+        nIters[cellI],
+        nFnEvals[cellI],
+        nEvals[cellI],
+        converged[cellI]
+    );
+}
+
+
+// Device copy of a host array
+template<class Type>
+class deviceArray
+{
+    // Device pointer
+    Type* ptr_;
+
+    // Number of elements
+    int size_;
+
+public:
+
+    // Constructor
+    deviceArray(const int size)
+    :
+        ptr_(NULL),
+        size_(size)
+    {
+        if (cudaMalloc(&ptr_, size_ * sizeof(Type)) != cudaSuccess)
+        {
+            ptr_ = NULL;
+        }
+    }
+
+    // Destructor
+    ~deviceArray()
+    {
+        if (ptr_)
+        {
+            cudaFree(ptr_);
+        }
+    }
+
+    // Was the allocation successful?
+    bool valid() const
+    {
+        return (ptr_ != NULL);
+    }
+
+    // Return device pointer
+    Type* ptr()
+    {
+        return ptr_;
+    }
+
+    // Copy from the host
+    bool copyIn(const Type* host)
+    {
+        return
+        (
+            cudaMemcpy
+            (
+                ptr_, host, size_ * sizeof(Type), cudaMemcpyHostToDevice
+            )
+         == cudaSuccess
+        );
+    }
+
+    // Copy to the host
+    bool copyOut(Type* host) const
+    {
+        return
+        (
+            cudaMemcpy
+            (
+                host, ptr_, size_ * sizeof(Type), cudaMemcpyDeviceToHost
+            )
+         == cudaSuccess
+        );
+    }
+};
+
+
+// * * * * * * * * * * * * * * * Global Functions  * * * * * * * * * * * * * //
+
+// Is a device available?
+bool available()
+{
+    int nDevices = 0;
+
+    return (cudaGetDeviceCount(&nDevices) == cudaSuccess && nDevices > 0);
+}
+
+
+// Reconstruct a batch of cells on the device
+bool reconstruct
+(
+    const int nCells,
+    const int* offsets,
+    const double* tets,
+    const double* fractions,
+    const double* refCentres,
+    const double* seeds,
+    const MoFKernel::settings& s,
+    double* normals,
+    double* distances,
+    double* centres,
+    int* nIters,
+    int* nFnEvals,
+    int* nEvals,
+    int* converged
+)
+{
+    if (nCells == 0)
+    {
+        return true;
+    }
+
+    if (!available())
+    {
+        return false;
+    }
+
+    const int nTets = offsets[nCells];
+
+    deviceArray<int> dOffsets(nCells + 1);
+    deviceArray<double> dTets(12 * nTets);
+    deviceArray<double> dFractions(nCells);
+    deviceArray<double> dRefCentres(3 * nCells);
+    deviceArray<double> dSeeds(3 * nCells);
+    deviceArray<double> dNormals(3 * nCells);
+    deviceArray<double> dDistances(nCells);
+    deviceArray<double> dCentres(3 * nCells);
+    deviceArray<int> dIters(nCells);
+    deviceArray<int> dFnEvals(nCells);
+    deviceArray<int> dEvals(nCells);
+    deviceArray<int> dConverged(nCells);
+
+    bool ok =
+    (
+        dOffsets.valid() && dTets.valid() && dFractions.valid()
+     && dRefCentres.valid() && dSeeds.valid() && dNormals.valid()
+     && dDistances.valid() && dCentres.valid() && dIters.valid()
+     && dFnEvals.valid() && dEvals.valid() && dConverged.valid()
+    );
+
+    ok =
+    (
+        ok
+     && dOffsets.copyIn(offsets)
+     && dTets.copyIn(tets)
+     && dFractions.copyIn(fractions)
+     && dRefCentres.copyIn(refCentres)
+     && dSeeds.copyIn(seeds)
+    );
+
+    if (!ok)
+    {
+        return false;
+    }
+
+    const int nBlocks = (nCells + blockSize - 1) / blockSize;
+
+    reconstructKernel<<<nBlocks, blockSize>>>
+    (
+        nCells,
+        dOffsets.ptr(),
+        dTets.ptr(),
+        dFractions.ptr(),
+        dRefCentres.ptr(),
+        dSeeds.ptr(),
+        s,
+        dNormals.ptr(),
+        dDistances.ptr(),
+        dCentres.ptr(),
+        dIters.ptr(),
+        dFnEvals.ptr(),
+        dEvals.ptr(),
+        dConverged.ptr()
+    );
+
+    if
+    (
+        cudaGetLastError() != cudaSuccess
+     || cudaDeviceSynchronize() != cudaSuccess
+    )
+    {
+        return false;
+    }
+
+    return
+    (
+        dNormals.copyOut(normals)
+     && dDistances.copyOut(distances)
+     && dCentres.copyOut(centres)
+     && dIters.copyOut(nIters)
+     && dFnEvals.copyOut(nFnEvals)
+     && dEvals.copyOut(nEvals)
+     && dConverged.copyOut(converged)
+    );
+}
+
+} // End namespace MoFDevice
+
+} // End namespace Foam
+
+// ************************************************************************* //
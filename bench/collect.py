@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------
+# Gather the logs of one benchmark run into a JSON record, and merge the
+# records of a suite into a single results file.
+#
+# Usage:
+#     collect.py record <records.jsonl> <case> <initLog> <initWall>
+#         <mofLog> <mofWall> key=value ...
+#     collect.py merge <records.jsonl> <results.json> key=value ...
+#
+# Keys passed as key=value are stored with the record; exactVolume and
+# exactCentre ("x y z") give the reference for the accuracy figures.
+#------------------------------------------------------------------------------
+
+import json
+import math
+import os
+import re
+import sys
+
+NUMBER = r"([-+0-9.eE]+|nan|inf)"
+
+
+def find(text, pattern, cast=float, group=1):
+    match = re.search(pattern, text)
+    return cast(match.group(group)) if match else None
+
+
+def nCells(case):
+    owner = os.path.join(case, "constant", "polyMesh", "owner")
+    with open(owner, errors="replace") as f:
+        head = f.read(4096)
+    return find(head, r"nCells:\s*(\d+)", int)
+
+
+def parseInit(text):
+    stats = {
+        "tetTestsRejected": find(text, r"Clip tests rejected: " + NUMBER),
+        "tetTestsAccepted": find(text, r" accepted: " + NUMBER),
+        "tetTestsClipped": find(text, r" clipped: " + NUMBER),
+        "convexSourceCells": find(text, r"Convex source cells: (\d+)", int),
+        "cellsInside": find(text, r"Cells inside: (\d+)", int),
+        "cellsCut": find(text, r" cut: (\d+)", int),
+        "integratedTets": find(text, r"integrated tets: (\d+)", int),
+    }
+    counts = [
+        stats[k] for k in
+        ("tetTestsRejected", "tetTestsAccepted", "tetTestsClipped")
+    ]
+    if all(c is not None for c in counts):
+        stats["tetTests"] = sum(counts)
+    return {k: v for k, v in stats.items() if v is not None}
+
+
+def parseMoF(text):
+    stats = {
+        "mixedCells": find(text, r"Mixed cells: (\d+)", int),
+        "unconverged": find(text, r"unconverged: (\d+)", int),
+        "bfgsIterations": find(text, r"BFGS iterations: (\d+)", int),
+        "fnEvals": find(text, r"Functional evaluations: (\d+)", int),
+        "fnEvalsPerCell": find(
+            text, r"Functional evaluations: \d+ per cell: " + NUMBER
+        ),
+        "matchSolves": find(text, r"Solves: (\d+)", int),
+        "matchEvals": find(text, r"Solves: \d+ evaluations: (\d+)", int),
+        "fallbacks": find(text, r"Full-accuracy re-runs: (\d+)", int),
+        "reconstructionTime": find(
+            text, r"Reconstruction \(wall\): " + NUMBER
+        ),
+        "maxCentroidError": find(text, r"Centroid error: max " + NUMBER),
+        "meanCentroidError": find(text, r" mean " + NUMBER),
+    }
+    return {k: v for k, v in stats.items() if v is not None}
+
+
+def parseMaterial(text):
+    match = re.search(
+        r"Material volume: " + NUMBER +
+        r" centroid: \(" + NUMBER + " " + NUMBER + " " + NUMBER + r"\)",
+        text
+    )
+    if not match:
+        return None, None
+    values = [float(x) for x in match.groups()]
+    return values[0], values[1:]
+
+
+def read(path):
+    if not os.path.isfile(path):
+        return ""
+    with open(path, errors="replace") as f:
+        return f.read()
+
+
+def keyValues(args):
+    meta = {}
+    for arg in args:
+        key, _, value = arg.partition("=")
+        try:
+            meta[key] = int(value)
+        except ValueError:
+            try:
+                meta[key] = float(value)
+            except ValueError:
+                meta[key] = value
+    return meta
+
+
+def record(argv):
+    out, case, initLog, initWall, mofLog, mofWall = argv[:6]
+    meta = keyValues(argv[6:])
+
+    exactVolume = meta.pop("exactVolume", None)
+    exactCentre = meta.pop("exactCentre", None)
+
+    initText = read(initLog)
+    mofText = read(mofLog)
+
+    rec = dict(meta)
+    rec["nCells"] = nCells(case)
+    rec["ok"] = (
+        "Centroid error" in mofText
+        and "FOAM FATAL" not in initText + mofText
+    )
+
+    init = parseInit(initText)
+    init["wallTime"] = float(initWall)
+    if rec["nCells"] and init["wallTime"] > 0.0:
+        init["cellsPerSecond"] = rec["nCells"] / init["wallTime"]
+    if "tetTests" in init and init["wallTime"] > 0.0:
+        init["tetTestsPerSecond"] = init["tetTests"] / init["wallTime"]
+
+    mof = parseMoF(mofText)
+    mof["wallTime"] = float(mofWall)
+    t = mof.get("reconstructionTime", mof["wallTime"])
+    if "mixedCells" in mof and t > 0.0:
+        mof["mixedCellsPerSecond"] = mof["mixedCells"] / t
+
+    # Accuracy of the initialized fields against the exact geometry
+    volume, centroid = parseMaterial(mofText)
+    accuracy = {}
+    if volume is not None and exactVolume:
+        accuracy["volume"] = volume
+        accuracy["volumeError"] = abs(volume - exactVolume) / exactVolume
+    if centroid is not None and exactCentre:
+        c = [float(x) for x in str(exactCentre).split()]
+        accuracy["centroidError"] = math.sqrt(
+            sum((a - b) ** 2 for a, b in zip(centroid, c))
+        ) / exactVolume ** (1.0 / 3.0)
+
+    rec["init"] = init
+    rec["reconstruct"] = mof
+    rec["accuracy"] = accuracy
+
+    with open(out, "a") as f:
+        f.write(json.dumps(rec, sort_keys=True) + "\n")
+
+
+def merge(argv):
+    records, out = argv[:2]
+    results = keyValues(argv[2:])
+    with open(records) as f:
+        results["runs"] = [json.loads(line) for line in f if line.strip()]
+    with open(out, "w") as f:
+        json.dump(results, f, indent=2, sort_keys=True)
+        f.write("\n")
+
+
+def main(argv):
+    if len(argv) >= 8 and argv[1] == "record":
+        record(argv[2:])
+    elif len(argv) >= 4 and argv[1] == "merge":
+        merge(argv[2:])
+    else:
+        sys.exit("Usage: collect.py record|merge ...")
+
+
+if __name__ == "__main__":
+    main(sys.argv)
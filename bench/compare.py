@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------
+# Compare two benchmark results files, run by run.
+#
+# Usage:
+#     compare.py <base.json> <new.json> [tolerance]
+#
+# Runs are matched on mesh, size, interface, threads and procs. A run
+# regresses when a time or evaluation count grows by more than the
+# tolerance (default 0.1), or an error grows by more than ten times that.
+# The exit status is non-zero when any run regresses or fails.
+#------------------------------------------------------------------------------
+
+import json
+import sys
+
+KEY = ("mesh", "size", "interface", "threads", "procs")
+
+# Metric, and the relative growth allowed in multiples of the tolerance
+METRICS = (
+    ("init.wallTime", 1.0),
+    ("reconstruct.wallTime", 1.0),
+    ("reconstruct.reconstructionTime", 1.0),
+    ("reconstruct.fnEvals", 1.0),
+    ("reconstruct.matchEvals", 1.0),
+    ("accuracy.volumeError", 10.0),
+    ("accuracy.centroidError", 10.0),
+    ("reconstruct.maxCentroidError", 10.0),
+)
+
+
+def load(path):
+    with open(path) as f:
+        results = json.load(f)
+    return {tuple(r.get(k) for k in KEY): r for r in results["runs"]}
+
+
+def value(run, metric):
+    section, name = metric.split(".")
+    return run.get(section, {}).get(name)
+
+
+def main(argv):
+    if len(argv) not in (3, 4):
+        sys.exit("Usage: compare.py <base.json> <new.json> [tolerance]")
+
+    base = load(argv[1])
+    new = load(argv[2])
+    tol = float(argv[3]) if len(argv) == 4 else 0.1
+
+    failed = False
+
+    for key in sorted(new, key=str):
+        run = new[key]
+        label = " ".join("%s=%s" % kv for kv in zip(KEY, key))
+
+        if not run.get("ok", False):
+            print("%s: FAILED" % label)
+            failed = True
+            continue
+
+        if key not in base:
+            print("%s: no base run" % label)
+            continue
+
+        print(label)
+
+        for metric, scale in METRICS:
+            a = value(base[key], metric)
+            b = value(run, metric)
+            if a is None or b is None:
+                continue
+
+            # Errors near round-off are compared against a floor
+            floor = 1e-12 if scale > 1.0 else 0.0
+            ratio = (b + floor) / (a + floor) if a + floor > 0.0 else 1.0
+            worse = ratio > 1.0 + scale * tol
+
+            print(
+                "    %-34s %12.4g %12.4g %8.3f%s"
+                % (metric, a, b, ratio, "  REGRESSION" if worse else "")
+            )
+            failed = failed or worse
+
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main(sys.argv))
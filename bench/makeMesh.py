@@ -0,0 +1,190 @@
+#!/usr/bin/env python3
+#------------------------------------------------------------------------------
+# Write a structured hex or tet polyMesh on the unit cube, or on a sheared
+# slab inside it, for the benchmark cases.
+#
+# Usage:
+#     makeMesh.py <case> <hex|tet> <n> [-slab z0 h ax ay]
+#
+# The slab maps the unit cube to z0 + h*z + ax*x + ay*y, so that it spans
+# the cube in x and y between two tilted planes. Tet meshes split each hex
+# into the six tets about its main diagonal, which conform across hexes.
+#------------------------------------------------------------------------------
+
+import os
+import sys
+
+HEX_FACES = [
+    (0, 2, 6, 4), (1, 3, 7, 5),
+    (0, 1, 5, 4), (2, 3, 7, 6),
+    (0, 1, 3, 2), (4, 5, 7, 6),
+]
+
+HEX_TETS = [
+    (0, 1, 3, 7), (0, 3, 2, 7), (0, 2, 6, 7),
+    (0, 6, 4, 7), (0, 4, 5, 7), (0, 5, 1, 7),
+]
+
+TET_FACES = [(0, 1, 2), (0, 1, 3), (0, 2, 3), (1, 2, 3)]
+
+
+def sub(a, b):
+    return (a[0] - b[0], a[1] - b[1], a[2] - b[2])
+
+
+def centre(points, loop):
+    s = [0.0, 0.0, 0.0]
+    for p in loop:
+        for c in range(3):
+            s[c] += points[p][c]
+    return [x / len(loop) for x in s]
+
+
+def normal(points, loop):
+    # Newell's method
+    n = [0.0, 0.0, 0.0]
+    for i in range(len(loop)):
+        a = points[loop[i]]
+        b = points[loop[(i + 1) % len(loop)]]
+        n[0] += (a[1] - b[1]) * (a[2] + b[2])
+        n[1] += (a[2] - b[2]) * (a[0] + b[0])
+        n[2] += (a[0] - b[0]) * (a[1] + b[1])
+    return n
+
+
+def build(kind, n, slab):
+    m = n + 1
+    points = []
+    for k in range(m):
+        for j in range(m):
+            for i in range(m):
+                x, y, z = i / n, j / n, k / n
+                if slab:
+                    z0, h, ax, ay = slab
+                    z = z0 + h * z + ax * x + ay * y
+                points.append((x, y, z))
+
+    cells = []
+    for k in range(n):
+        for j in range(n):
+            for i in range(n):
+                v = [
+                    (i + di) + m * ((j + dj) + m * (k + dk))
+                    for dk in (0, 1) for dj in (0, 1) for di in (0, 1)
+                ]
+                if kind == "hex":
+                    cells.append([tuple(v[a] for a in f) for f in HEX_FACES])
+                else:
+                    for t in HEX_TETS:
+                        tv = [v[a] for a in t]
+                        cells.append(
+                            [tuple(tv[a] for a in f) for f in TET_FACES]
+                        )
+
+    # Match faces between cells, oriented out of the lower cell
+    shared = {}
+    for cellI, cell in enumerate(cells):
+        cc = centre(points, [p for f in cell for p in f])
+        for f in cell:
+            nf = normal(points, f)
+            d = sub(centre(points, f), cc)
+            if nf[0] * d[0] + nf[1] * d[1] + nf[2] * d[2] < 0.0:
+                f = tuple(reversed(f))
+            key = tuple(sorted(f))
+            if key in shared:
+                shared[key][1] = cellI
+            else:
+                shared[key] = [f, -1, cellI]
+
+    internal = []
+    boundary = []
+    for f, nei, own in shared.values():
+        if nei < 0:
+            boundary.append((own, f))
+        else:
+            internal.append((own, nei, f))
+
+    internal.sort(key=lambda x: (x[0], x[1]))
+    boundary.sort(key=lambda x: x[0])
+
+    faces = [f for _, _, f in internal] + [f for _, f in boundary]
+    owner = [o for o, _, _ in internal] + [o for o, _ in boundary]
+    neighbour = [nb for _, nb, _ in internal]
+
+    return points, faces, owner, neighbour, len(cells)
+
+
+def header(cls, obj, note=None):
+    s = (
+        "FoamFile\n{\n"
+        "    version     2.0;\n"
+        "    format      ascii;\n"
+        "    class       %s;\n" % cls
+    )
+    if note:
+        s += "    note        \"%s\";\n" % note
+    s += (
+        "    location    \"constant/polyMesh\";\n"
+        "    object      %s;\n}\n\n" % obj
+    )
+    return s
+
+
+def write(case, points, faces, owner, neighbour, nCells):
+    d = os.path.join(case, "constant", "polyMesh")
+    os.makedirs(d, exist_ok=True)
+
+    note = "nPoints:%d  nCells:%d  nFaces:%d  nInternalFaces:%d" % (
+        len(points), nCells, len(faces), len(neighbour)
+    )
+
+    with open(os.path.join(d, "points"), "w") as f:
+        f.write(header("vectorField", "points"))
+        f.write("%d\n(\n" % len(points))
+        for p in points:
+            f.write("(%.15g %.15g %.15g)\n" % p)
+        f.write(")\n")
+
+    with open(os.path.join(d, "faces"), "w") as f:
+        f.write(header("faceList", "faces"))
+        f.write("%d\n(\n" % len(faces))
+        for face in faces:
+            f.write("%d(%s)\n" % (len(face), " ".join(map(str, face))))
+        f.write(")\n")
+
+    for name, lst in (("owner", owner), ("neighbour", neighbour)):
+        with open(os.path.join(d, name), "w") as f:
+            f.write(header("labelList", name, note))
+            f.write("%d\n(\n" % len(lst))
+            f.write("\n".join(map(str, lst)))
+            f.write("\n)\n")
+
+    with open(os.path.join(d, "boundary"), "w") as f:
+        f.write(header("polyBoundaryMesh", "boundary"))
+        f.write(
+            "1\n(\n    walls\n    {\n"
+            "        type            wall;\n"
+            "        nFaces          %d;\n"
+            "        startFace       %d;\n"
+            "    }\n)\n" % (len(faces) - len(neighbour), len(neighbour))
+        )
+
+
+def main(argv):
+    if len(argv) not in (4, 9) or argv[2] not in ("hex", "tet"):
+        sys.exit(
+            "Usage: makeMesh.py <case> <hex|tet> <n> [-slab z0 h ax ay]"
+        )
+
+    slab = None
+    if len(argv) == 9:
+        if argv[4] != "-slab":
+            sys.exit("Unknown option: " + argv[4])
+        slab = [float(x) for x in argv[5:9]]
+
+    mesh = build(argv[2], int(argv[3]), slab)
+    write(argv[1], *mesh)
+
+
+if __name__ == "__main__":
+    main(sys.argv)